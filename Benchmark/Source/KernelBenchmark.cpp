@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: KernelBenchmark.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "KernelBenchmark.hpp"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+KernelBenchmark::KernelBenchmark(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned int repeats, double minimumTime) :
+    m_simulation (x, y, width, height),
+    m_repeats (repeats > 0 ? repeats : 1),
+    m_minimumTime (minimumTime),
+    m_dt (1.f / 60.f),
+    m_sink (0.f)
+{
+}
+
+void KernelBenchmark::run(const Scenario& scenario, std::vector<KernelResult>& results)
+{
+    load(scenario);
+
+    auto& simulation = m_simulation;
+    auto& boids      = m_simulation.m_boids;
+    auto  none       = [] {};
+    auto  reset      = [this] { restore(); };
+    auto  step       = [this] { restore(); advance(); };
+
+    results.push_back(measure("cohesion", none, [&] {
+        sf::Vector2f v;
+        for(auto& boid : boids)
+            v += simulation.applyCohesion(boid);
+        m_sink = v.x + v.y;
+    }));
+
+    results.push_back(measure("separation", none, [&] {
+        sf::Vector2f v;
+        for(auto& boid : boids)
+            v += simulation.applySeparation(boid);
+        m_sink = v.x + v.y;
+    }));
+
+    results.push_back(measure("alignment", none, [&] {
+        sf::Vector2f v;
+        for(auto& boid : boids)
+            v += simulation.applyAlignment(boid);
+        m_sink = v.x + v.y;
+    }));
+
+    results.push_back(measure("screenBound", none, [&] {
+        sf::Vector2f v;
+        for(auto& boid : boids)
+            v += simulation.applyScreenBound(boid);
+        m_sink = v.x + v.y;
+    }));
+
+    results.push_back(measure("mouse", none, [&] {
+        sf::Vector2f v;
+        for(auto& boid : boids)
+            v += simulation.applyMousePosition(boid);
+        m_sink = v.x + v.y;
+    }));
+
+    results.push_back(measure("wrapEdge", reset, [&] {
+        for(auto& boid : boids)
+            simulation.applyWrapEdge(boid);
+    }));
+
+    results.push_back(measure("velocityLimit", reset, [&] {
+        for(auto& boid : boids)
+            simulation.applyVelocityLimit(boid);
+    }));
+
+    results.push_back(measure("integration", reset, [&] {
+        for(auto& boid : boids)
+            simulation.applyIntegration(boid, sf::Vector2f(), m_dt);
+    }));
+
+    results.push_back(measure("neighbourSearch", none, [&] {
+        unsigned int neighbours = 0;
+        float radius = simulation.m_separationRadius + simulation.m_neighbourSlack;
+        for(auto& boid : boids)
+            simulation.m_grid.forEachNear(boid.getPosition(), radius, [&](unsigned int) { neighbours++; });
+        m_sink = static_cast<float>(neighbours);
+    }));
+
+    // Force the incremental path for grid maintenance; otherwise the path
+    // would depend on the migration rate restore measures against the
+    // previous call, which leaks state between iterations
+    float rebuildThreshold       = simulation.m_grid.getRebuildThreshold();
+    unsigned int compactInterval = simulation.m_grid.getCompactInterval();
+    simulation.m_grid.setRebuildThreshold(1.f);
+    simulation.m_grid.setCompactInterval(static_cast<unsigned int>(-1));
+
+    unsigned int calls    = 0;
+    unsigned int rebuilds = 0;
+
+    results.push_back(measure("gridUpdate", step, [&] {
+        simulation.m_grid.update(boids);
+        rebuilds += simulation.m_grid.getRebuilt() ? 1 : 0;
+        calls++;
+    }));
+    results.back().migrationRate = simulation.m_grid.getMigrationRate();
+    results.back().path          = getPath(rebuilds, calls);
+
+    calls    = 0;
+    rebuilds = 0;
+
+    results.push_back(measure("update", reset, [&] {
+        simulation.update(m_dt);
+        rebuilds += simulation.m_grid.getRebuilt() ? 1 : 0;
+        calls++;
+    }));
+    results.back().migrationRate = simulation.m_grid.getMigrationRate();
+    results.back().path          = getPath(rebuilds, calls);
+
+    simulation.m_grid.setRebuildThreshold(rebuildThreshold);
+    simulation.m_grid.setCompactInterval(compactInterval);
+
+    results.push_back(measure("gridRebuild", step, [&] {
+        simulation.m_grid.rebuild(boids);
+    }));
+    results.back().migrationRate = simulation.m_grid.getMigrationRate();
+    results.back().path          = "rebuild";
+}
+
+bool KernelBenchmark::hasCounters() const
+{
+    return m_counters.isAvailable();
+}
+
+double KernelBenchmark::getNanoseconds()
+{
+#ifdef _WIN32
+    // steady_clock has millisecond resolution on the v120 toolset
+    static LARGE_INTEGER frequency = {};
+    if(frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    return static_cast<double>(counter.QuadPart) / static_cast<double>(frequency.QuadPart) * 1000000000.0;
+#else
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+}
+
+std::string KernelBenchmark::getPath(unsigned int rebuilds, unsigned int calls)
+{
+    if(rebuilds == 0)
+        return "incremental";
+    if(rebuilds == calls)
+        return "rebuild";
+
+    return "mixed";
+}
+
+void KernelBenchmark::load(const Scenario& scenario)
+{
+    m_scenario = scenario.name;
+    m_initial.clear();
+
+    for(unsigned int i = 0; i < scenario.positions.size(); i++)
+    {
+        Boid boid(m_texture, scenario.positions[i]);
+        boid.setVelocity(scenario.velocities[i]);
+        m_initial.push_back(boid);
+    }
+
+    m_simulation.setWrapEdge(scenario.wrapEdge);
+
+    // Mouse in the middle of the simulation area
+    m_simulation.setMousePosition({(m_simulation.m_x + m_simulation.m_width) / 2.f, (m_simulation.m_y + m_simulation.m_height) / 2.f});
+}
+
+void KernelBenchmark::restore()
+{
+    m_simulation.m_boids = m_initial;
+    m_simulation.m_grid.rebuild(m_simulation.m_boids);
+    m_simulation.m_neighbourSlack = m_simulation.m_maxVelocity * m_dt;
+}
+
+void KernelBenchmark::advance()
+{
+    // Move every boid one tick so the grid has migrations to process
+    for(auto& boid : m_simulation.m_boids)
+        boid.setPosition(boid.getPosition() + boid.getVelocity() * m_dt);
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: KernelBenchmark.hpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+#ifndef KERNEL_BENCHMARK_HPP
+#define KERNEL_BENCHMARK_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Simulation.hpp"
+#include "PerfCounters.hpp"
+#include "Scenario.hpp"
+
+struct KernelResult
+{
+    std::string scenario;
+    std::string kernel;
+    double      nanoseconds;
+    double      fastest;
+    double      migrationRate;
+    std::string path;
+    double      cycles;
+    double      cacheMisses;
+    double      branchMisses;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Runs each simulation kernel on its own over a scenario. A repeat starts from
+// the scenario's initial state and calls the kernel until at least
+// m_minimumTime of kernel time has passed, averaging over the calls. Kernels
+// that change the flock pass a setup that restores it before every call. The
+// median repeat is reported, scaled to one boid, along with the fastest one.
+////////////////////////////////////////////////////////////////////////////////
+class KernelBenchmark
+{
+public:
+
+    KernelBenchmark(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned int repeats, double minimumTime);
+
+    void run(const Scenario& scenario, std::vector<KernelResult>& results);
+
+    bool hasCounters() const;
+
+private:
+
+    void load(const Scenario& scenario);
+    void restore();
+    void advance();
+
+    template <typename Setup, typename Kernel>
+    KernelResult measure(const std::string& name, Setup setup, Kernel kernel);
+
+    static double getNanoseconds();
+    static std::string getPath(unsigned int rebuilds, unsigned int calls);
+
+private:
+
+    Simulation        m_simulation;
+    sf::Texture       m_texture;
+    std::vector<Boid> m_initial;
+    std::string       m_scenario;
+    PerfCounters      m_counters;
+    unsigned int      m_repeats;
+    double            m_minimumTime;
+    float             m_dt;
+    volatile float    m_sink;
+};
+
+template <typename Setup, typename Kernel>
+KernelResult KernelBenchmark::measure(const std::string& name, Setup setup, Kernel kernel)
+{
+    KernelResult result;
+    result.scenario      = m_scenario;
+    result.kernel        = name;
+    result.migrationRate = -1.0;
+    result.path          = "-";
+
+    double boids = m_initial.empty() ? 1.0 : static_cast<double>(m_initial.size());
+
+    std::vector<KernelResult> samples;
+    for(unsigned int i = 0; i < m_repeats; i++)
+    {
+        double elapsed    = 0.0;
+        double iterations = 0.0;
+        m_counters.reset();
+        restore();
+
+        while(elapsed < m_minimumTime)
+        {
+            setup();
+
+            m_counters.start();
+            double start = getNanoseconds();
+            kernel();
+            double end = getNanoseconds();
+            m_counters.stop();
+
+            elapsed += end - start;
+            iterations++;
+        }
+
+        double count = iterations * boids;
+
+        KernelResult sample = result;
+        sample.nanoseconds  = elapsed / count;
+        sample.cycles       = m_counters.getValue(PerfCounters::Cycles) / count;
+        sample.cacheMisses  = m_counters.getValue(PerfCounters::CacheMisses) / count;
+        sample.branchMisses = m_counters.getValue(PerfCounters::BranchMisses) / count;
+        samples.push_back(sample);
+    }
+
+    // The median shrugs off repeats disturbed by the rest of the system
+    std::sort(samples.begin(), samples.end(), [](const KernelResult& a, const KernelResult& b) {
+        return a.nanoseconds < b.nanoseconds;
+    });
+
+    KernelResult median = samples[samples.size() / 2];
+    median.fastest      = samples.front().nanoseconds;
+    return median;
+}
+
+#endif
\ No newline at end of file
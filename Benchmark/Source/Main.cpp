@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: Main.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "KernelBenchmark.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+std::string getConfiguration(unsigned int boids, unsigned int repeats, double minimumTime);
+std::map<std::string, double> loadBaseline(const std::string& filename, std::string& configuration);
+void saveBaseline(const std::string& filename, const std::string& configuration, const std::vector<KernelResult>& results);
+void printUsage();
+
+////////////////////////////////////////////////////////////////////////////////
+// Entry point of application
+//
+// Usage: Benchmark [--boids n] [--repeats n] [--min-time ms] [--baseline file]
+//                  [--threshold percent] [--noise-floor ns] [--save file]
+//
+// Returns 1 when even the fastest repeat of a kernel is more than threshold
+// percent, and more than noise-floor nanoseconds per boid, slower than the
+// median time stored for it in the baseline file. Returns 2 on bad arguments, when the baseline was recorded
+// with a different boid count, repeat count or minimum time, or when it lacks
+// a usable time for any kernel.
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    unsigned int boids       = 1000;
+    unsigned int repeats     = 10;
+    double       minimumTime = 10.0;
+    double       threshold   = 10.0;
+    double       noiseFloor  = 1.0;
+    std::string  baseline;
+    std::string  save;
+
+    for(int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if(i + 1 >= argc)
+        {
+            printUsage();
+            return 2;
+        }
+
+        if(argument == "--boids")
+            boids = std::atoi(argv[++i]);
+        else if(argument == "--repeats")
+            repeats = std::atoi(argv[++i]);
+        else if(argument == "--min-time")
+            minimumTime = std::atof(argv[++i]);
+        else if(argument == "--threshold")
+            threshold = std::atof(argv[++i]);
+        else if(argument == "--noise-floor")
+            noiseFloor = std::atof(argv[++i]);
+        else if(argument == "--baseline")
+            baseline = argv[++i];
+        else if(argument == "--save")
+            save = argv[++i];
+        else
+        {
+            printUsage();
+            return 2;
+        }
+    }
+
+    // Same simulation area as the application window
+    const unsigned int width   = 1600;
+    const unsigned int height  = 900;
+    const unsigned int padding = 25;
+
+    KernelBenchmark benchmark(200, padding, width - padding, height - padding, repeats, minimumTime * 1000000.0);
+    std::string configuration = getConfiguration(boids, repeats, minimumTime);
+    sf::FloatRect bounds(200.f, padding, width - padding - 200.f, height - 2.f * padding);
+
+    std::vector<KernelResult> results;
+    for(const auto& scenario : createScenarios(boids, bounds))
+        benchmark.run(scenario, results);
+
+    bool counters = benchmark.hasCounters();
+    if(!counters)
+        std::cout << "Hardware counters unavailable: they need perf_event_open, which only Linux builds use and the kernel may deny" << std::endl;
+
+    std::cout << std::left  << std::setw(12) << "Scenario" << std::setw(18) << "Kernel"
+              << std::right << std::setw(12) << "ns/boid" << std::setw(12) << "migrated %" << std::setw(13) << "grid path";
+    if(counters)
+        std::cout << std::setw(12) << "cycles" << std::setw(12) << "cache miss" << std::setw(12) << "branch miss";
+    std::cout << std::endl;
+
+    for(const auto& result : results)
+    {
+        std::cout << std::left  << std::setw(12) << result.scenario << std::setw(18) << result.kernel
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(12) << result.nanoseconds;
+
+        if(result.migrationRate < 0.0)
+            std::cout << std::setw(12) << "-";
+        else
+            std::cout << std::setw(12) << result.migrationRate * 100.0;
+
+        std::cout << std::setw(13) << result.path;
+
+        if(counters)
+            std::cout << std::setw(12) << result.cycles << std::setw(12) << result.cacheMisses
+                      << std::setw(12) << result.branchMisses;
+        std::cout << std::endl;
+    }
+
+    int status = 0;
+    if(!baseline.empty())
+    {
+        std::string recorded;
+        auto reference = loadBaseline(baseline, recorded);
+        if(reference.empty())
+        {
+            std::cerr << "Could not read baseline " << baseline << std::endl;
+            return 2;
+        }
+
+        // Times scale with the flock size and settle with more samples, so
+        // only runs configured alike are comparable
+        if(recorded != configuration)
+        {
+            std::cerr << "Baseline was recorded with '" << recorded << "', this run uses '" << configuration << "'" << std::endl;
+            return 2;
+        }
+
+        for(const auto& result : results)
+        {
+            auto it = reference.find(result.scenario + " " + result.kernel);
+            if(it == reference.end() || it->second <= 0.0)
+            {
+                std::cerr << "Baseline has no usable time for " << result.scenario << " " << result.kernel << std::endl;
+                status = 2;
+                continue;
+            }
+
+            // Judge the fastest repeat so a few disturbed repeats can't fail the run
+            double change = (result.fastest - it->second) / it->second * 100.0;
+            if(change > threshold && result.fastest - it->second > noiseFloor)
+            {
+                std::cout << "REGRESSION " << result.scenario << " " << result.kernel << ": "
+                          << std::setprecision(1) << change << "% slower than baseline" << std::endl;
+                if(status == 0)
+                    status = 1;
+            }
+        }
+    }
+
+    if(!save.empty())
+        saveBaseline(save, configuration, results);
+
+    return status;
+}
+
+std::string getConfiguration(unsigned int boids, unsigned int repeats, double minimumTime)
+{
+    std::stringstream ss;
+    ss << "boids " << boids << " repeats " << repeats << " min-time " << std::fixed << std::setprecision(3) << minimumTime;
+
+    return ss.str();
+}
+
+std::map<std::string, double> loadBaseline(const std::string& filename, std::string& configuration)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream file(filename);
+
+    // First line holds the run configuration
+    std::string header;
+    std::getline(file, header);
+    if(header.compare(0, 7, "config ") != 0)
+        return baseline;
+
+    configuration = header.substr(7);
+
+    std::string scenario;
+    std::string kernel;
+    double nanoseconds;
+    while(file >> scenario >> kernel >> nanoseconds)
+        baseline[scenario + " " + kernel] = nanoseconds;
+
+    return baseline;
+}
+
+void saveBaseline(const std::string& filename, const std::string& configuration, const std::vector<KernelResult>& results)
+{
+    std::ofstream file(filename);
+    file << "config " << configuration << "\n";
+    file << std::fixed << std::setprecision(3);
+
+    for(const auto& result : results)
+        file << result.scenario << " " << result.kernel << " " << result.nanoseconds << "\n";
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: Benchmark [--boids n] [--repeats n] [--min-time ms] [--baseline file] [--threshold percent] [--noise-floor ns] [--save file]" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: PerfCounters.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "PerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+#ifdef __linux__
+static int openCounter(unsigned long long config)
+{
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type           = PERF_TYPE_HARDWARE;
+    attributes.size           = sizeof(attributes);
+    attributes.config         = config;
+    attributes.disabled       = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+#endif
+
+PerfCounters::PerfCounters()
+{
+    for(int i = 0; i < Count; i++)
+    {
+        m_descriptors[i] = -1;
+        m_values[i]      = 0;
+    }
+
+#ifdef __linux__
+    m_descriptors[Cycles]       = openCounter(PERF_COUNT_HW_CPU_CYCLES);
+    m_descriptors[CacheMisses]  = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+    m_descriptors[BranchMisses] = openCounter(PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for(int i = 0; i < Count; i++)
+        if(m_descriptors[i] != -1)
+            close(m_descriptors[i]);
+#endif
+}
+
+bool PerfCounters::isAvailable() const
+{
+    for(int i = 0; i < Count; i++)
+        if(m_descriptors[i] != -1)
+            return true;
+
+    return false;
+}
+
+void PerfCounters::reset()
+{
+    for(int i = 0; i < Count; i++)
+    {
+        m_values[i] = 0;
+#ifdef __linux__
+        if(m_descriptors[i] != -1)
+            ioctl(m_descriptors[i], PERF_EVENT_IOC_RESET, 0);
+#endif
+    }
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for(int i = 0; i < Count; i++)
+        if(m_descriptors[i] != -1)
+            ioctl(m_descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+void PerfCounters::stop()
+{
+#ifdef __linux__
+    for(int i = 0; i < Count; i++)
+    {
+        if(m_descriptors[i] == -1)
+            continue;
+
+        ioctl(m_descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+        if(read(m_descriptors[i], &m_values[i], sizeof(m_values[i])) != sizeof(m_values[i]))
+            m_values[i] = 0;
+    }
+#endif
+}
+
+unsigned long long PerfCounters::getValue(Counter counter) const
+{
+    return m_values[counter];
+}
\ No newline at end of file
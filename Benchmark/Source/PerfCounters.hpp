@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: PerfCounters.hpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Hardware counters for cycles, cache misses and branch misses, read through
+// perf_event_open. Only Linux builds have them; the Win32 project shipped in
+// this repository does not, so there (or when the kernel refuses access)
+// isAvailable returns false and every counter reads zero.
+//
+// Counts accumulate over any number of start/stop pairs until reset.
+////////////////////////////////////////////////////////////////////////////////
+class PerfCounters
+{
+public:
+
+    enum Counter
+    {
+        Cycles,
+        CacheMisses,
+        BranchMisses,
+        Count
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    bool isAvailable() const;
+
+    void reset();
+    void start();
+    void stop();
+
+    unsigned long long getValue(Counter counter) const;
+
+private:
+
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+
+private:
+
+    int                m_descriptors[Count];
+    unsigned long long m_values[Count];
+};
+
+#endif
\ No newline at end of file
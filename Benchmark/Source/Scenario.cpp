@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: Scenario.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "Scenario.hpp"
+#include <random>
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+static Scenario createScenario(const std::string& name, bool wrapEdge)
+{
+    Scenario scenario;
+    scenario.name     = name;
+    scenario.wrapEdge = wrapEdge;
+
+    return scenario;
+}
+
+static void addBoid(Scenario& scenario, std::mt19937& random, const sf::Vector2f& position)
+{
+    std::uniform_real_distribution<float> velocity(-100.f, 100.f);
+
+    scenario.positions.push_back(position);
+    scenario.velocities.push_back({velocity(random), velocity(random)});
+}
+
+std::vector<Scenario> createScenarios(unsigned int boids, const sf::FloatRect& bounds)
+{
+    std::vector<Scenario> scenarios;
+    std::mt19937 random(2014);
+
+    std::uniform_real_distribution<float> x(bounds.left, bounds.left + bounds.width);
+    std::uniform_real_distribution<float> y(bounds.top, bounds.top + bounds.height);
+    sf::Vector2f center(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+
+    // Boids spread evenly over the whole area
+    Scenario uniform = createScenario("uniform", false);
+    for(unsigned int i = 0; i < boids; i++)
+        addBoid(uniform, random, {x(random), y(random)});
+    scenarios.push_back(uniform);
+
+    // Every boid packed into one ball in the middle
+    Scenario ball = createScenario("ball", false);
+    std::normal_distribution<float> spread(0.f, 30.f);
+    for(unsigned int i = 0; i < boids; i++)
+        addBoid(ball, random, center + sf::Vector2f(spread(random), spread(random)));
+    scenarios.push_back(ball);
+
+    // Many small flocks scattered over the area
+    Scenario clusters = createScenario("clusters", false);
+    std::normal_distribution<float> cluster(0.f, 10.f);
+    std::vector<sf::Vector2f> centers;
+    for(unsigned int i = 0; i < boids / 20 + 1; i++)
+        centers.push_back({x(random), y(random)});
+    for(unsigned int i = 0; i < boids; i++)
+        addBoid(clusters, random, centers[i % centers.size()] + sf::Vector2f(cluster(random), cluster(random)));
+    scenarios.push_back(clusters);
+
+    // Boids hugging the four edges, half of them just outside
+    std::uniform_real_distribution<float> offset(-10.f, 10.f);
+    std::uniform_int_distribution<int> side(0, 3);
+    Scenario edge = createScenario("edge", false);
+    for(unsigned int i = 0; i < boids; i++)
+    {
+        switch(side(random))
+        {
+        case 0:  addBoid(edge, random, {bounds.left + offset(random), y(random)});                break;
+        case 1:  addBoid(edge, random, {bounds.left + bounds.width + offset(random), y(random)}); break;
+        case 2:  addBoid(edge, random, {x(random), bounds.top + offset(random)});                 break;
+        default: addBoid(edge, random, {x(random), bounds.top + bounds.height + offset(random)}); break;
+        }
+    }
+    scenarios.push_back(edge);
+
+    Scenario edgeWrap = edge;
+    edgeWrap.name     = "edge-wrap";
+    edgeWrap.wrapEdge = true;
+    scenarios.push_back(edgeWrap);
+
+    return scenarios;
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: Scenario.hpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// A canned starting state for the kernels. Scenarios are generated from a
+// fixed seed so every run measures the same flock.
+////////////////////////////////////////////////////////////////////////////////
+struct Scenario
+{
+    std::string               name;
+    bool                      wrapEdge;
+    std::vector<sf::Vector2f> positions;
+    std::vector<sf::Vector2f> velocities;
+};
+
+std::vector<Scenario> createScenarios(unsigned int boids, const sf::FloatRect& bounds);
+
+#endif
\ No newline at end of file
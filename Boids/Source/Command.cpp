@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: Command.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "Command.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+Command::Command() :
+    type (PopBoid),
+    value (0.f),
+    integer (0),
+    flag (false),
+    texture (nullptr),
+    tick (0)
+{
+}
+
+Command::Command(Type type, float value) :
+    type (type),
+    value (value),
+    integer (0),
+    flag (false),
+    texture (nullptr),
+    tick (0)
+{
+}
+
+Command::Command(Type type, int value) :
+    type (type),
+    value (0.f),
+    integer (value),
+    flag (false),
+    texture (nullptr),
+    tick (0)
+{
+}
+
+Command::Command(Type type, bool value) :
+    type (type),
+    value (0.f),
+    integer (0),
+    flag (value),
+    texture (nullptr),
+    tick (0)
+{
+}
+
+Command::Command(Type type, const sf::Vector2f& position) :
+    type (type),
+    value (0.f),
+    integer (0),
+    flag (false),
+    position (position),
+    texture (nullptr),
+    tick (0)
+{
+}
+
+Command::Command(Type type, int count, const sf::FloatRect& area, const sf::Texture& texture) :
+    type (type),
+    value (0.f),
+    integer (count),
+    flag (false),
+    area (area),
+    texture (&texture),
+    tick (0)
+{
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: Command.hpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+#ifndef COMMAND_HPP
+#define COMMAND_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+
+namespace sf
+{
+    class Texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// A single mutation of the simulation. Commands are queued by any thread and
+// applied in order by Simulation::applyCommands at the start of a tick. Tick
+// is never queued; it marks the end of a tick in the command log and carries
+// that tick's time step in value. AddBoid spawns integer boids at random
+// positions inside area.
+////////////////////////////////////////////////////////////////////////////////
+struct Command
+{
+    enum Type
+    {
+        SetCohesion,
+        SetSeparation,
+        SetSeparationRadius,
+        SetAlignment,
+        SetBaseVelocity,
+        SetMaxVelocity,
+        SetMouseStrength,
+        SetMouseRadius,
+        SetMousePosition,
+        SetFollowMouse,
+        SetAvoidMouse,
+        SetDrawMouseRadius,
+        SetWrapEdge,
+        SetSeed,
+        AddBoid,
+        PopBoid,
+        Tick
+    };
+
+    Command();
+    Command(Type type, float value);
+    Command(Type type, int value);
+    Command(Type type, bool value);
+    Command(Type type, const sf::Vector2f& position);
+    Command(Type type, int count, const sf::FloatRect& area, const sf::Texture& texture);
+
+    Type               type;
+    float              value;
+    int                integer;
+    bool               flag;
+    sf::Vector2f       position;
+    sf::FloatRect      area;
+    const sf::Texture* texture;
+    unsigned int       tick;
+};
+
+#endif
\ No newline at end of file
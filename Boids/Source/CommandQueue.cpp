@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: CommandQueue.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "CommandQueue.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+CommandQueue::CommandQueue(unsigned int capacity) :
+    m_slots (nullptr),
+    m_mask (0),
+    m_pushPosition (0),
+    m_popPosition (0)
+{
+    // Round up to a power of two so positions wrap with a mask
+    unsigned int size = 2;
+    while(size < capacity)
+        size *= 2;
+
+    m_slots = new Slot[size];
+    m_mask  = size - 1;
+
+    for(unsigned int i = 0; i < size; i++)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+CommandQueue::~CommandQueue()
+{
+    delete[] m_slots;
+}
+
+bool CommandQueue::push(const Command& command)
+{
+    unsigned int position = m_pushPosition.load(std::memory_order_relaxed);
+
+    for(;;)
+    {
+        Slot& slot = m_slots[position & m_mask];
+        unsigned int sequence = slot.sequence.load(std::memory_order_acquire);
+        int difference = static_cast<int>(sequence - position);
+
+        // The slot is free for this position; claim it
+        if(difference == 0)
+        {
+            if(m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.command = command;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        // The consumer hasn't freed the slot yet: the ring is full
+        else if(difference < 0)
+            return false;
+        // Another producer claimed it first
+        else
+            position = m_pushPosition.load(std::memory_order_relaxed);
+    }
+}
+
+bool CommandQueue::pop(Command& command)
+{
+    Slot& slot = m_slots[m_popPosition & m_mask];
+    if(slot.sequence.load(std::memory_order_acquire) != m_popPosition + 1)
+        return false;
+
+    // Hand the slot back to producers one lap later
+    command = slot.command;
+    slot.sequence.store(m_popPosition + m_mask + 1, std::memory_order_release);
+    m_popPosition++;
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: CommandQueue.hpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+#ifndef COMMAND_QUEUE_HPP
+#define COMMAND_QUEUE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include <atomic>
+#include "Command.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Bounded lock-free multi-producer single-consumer queue. Commands live in a
+// ring of slots allocated once up front, each tagged with a sequence number
+// that tells producers and the consumer whose turn it is, so neither side
+// touches the heap. push may be called from any thread and fails when the ring
+// is full; pop only from the thread that owns the simulation.
+////////////////////////////////////////////////////////////////////////////////
+class CommandQueue
+{
+public:
+
+    explicit CommandQueue(unsigned int capacity = 4096);
+    ~CommandQueue();
+
+    bool push(const Command& command);
+    bool pop(Command& command);
+
+private:
+
+    CommandQueue(const CommandQueue&);
+    CommandQueue& operator=(const CommandQueue&);
+
+    struct Slot
+    {
+        std::atomic<unsigned int> sequence;
+        Command                   command;
+    };
+
+private:
+
+    Slot*                     m_slots;
+    unsigned int              m_mask;
+    std::atomic<unsigned int> m_pushPosition;
+    unsigned int              m_popPosition;
+};
+
+#endif
\ No newline at end of file
@@ -10,11 +10,12 @@
 #include <SFX/Sfx.hpp>
 #include "Simulation.hpp"
 #include <iomanip>
+#include <functional>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Methods
 ////////////////////////////////////////////////////////////////////////////////
-void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulation& simulation);
+void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulation& simulation, std::function<void()>& refreshGui);
 std::string convert(const std::string& prefix, float value, int precision);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,16 +30,15 @@ int main()
     const int padding = 25;
     Simulation simulation(200, padding, width - padding, height - padding);
 
-    for(int i = 0; i < 100; i++)
-    {
-        float x = static_cast<float>(sfx::getRandom(0, width));
-        float y = static_cast<float>(sfx::getRandom(0, height));
-
-        simulation.addBoid(Boid(application.getTexture("Assets/Images/Boid.png"), {x, y}));
-    }
+    // Spawn positions come from the simulation's own generator so a recorded
+    // session replays identically; only the seed is picked here
+    sf::FloatRect area(0.f, 0.f, static_cast<float>(width), static_cast<float>(height));
+    simulation.push(Command(Command::SetSeed, static_cast<int>(sfx::getRandom(0, 1 << 30))));
+    simulation.push(Command(Command::AddBoid, 100, area, application.getTexture("Assets/Images/Boid.png")));
 
+    std::function<void()> refreshGui;
     sfx::GuiManager guiManager(application);
-    initGui(application, guiManager, simulation);
+    initGui(application, guiManager, simulation, refreshGui);
 
     sf::Clock clock;
     while(application.isOpen())
@@ -57,8 +57,9 @@ int main()
             guiManager.onEvent(event);
         }
 
-        simulation.setMousePosition(static_cast<sf::Vector2f>(sf::Mouse::getPosition(application)));
+        simulation.push(Command(Command::SetMousePosition, static_cast<sf::Vector2f>(sf::Mouse::getPosition(application))));
         simulation.update(clock.restart().asSeconds());
+        refreshGui();
 
         guiManager.onUpdate();
 
@@ -71,7 +72,7 @@ int main()
     return 0;
 }
 
-void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulation& simulation)
+void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulation& simulation, std::function<void()>& refreshGui)
 {
     const std::string background    = "Assets/Images/Background.png";
     const std::string slider        = "Assets/Images/Slider";
@@ -96,6 +97,7 @@ void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulat
     const std::string mouseStrength    = convert("Mouse strength: ", simulation.getMouseStrength(), 3);
     const std::string mouseRadius      = convert("Mouse radius: ", static_cast<float>(simulation.getMouseRadius()), 0);
     const std::string wrapEdge         = "Wrap edge: ";
+    const std::string migrationRate    = convert("Grid migration: ", 0.f, 1) + "%";
 
     guiManager.createPicture("background", background);
 
@@ -112,6 +114,7 @@ void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulat
     auto& labelMouseStrength    = guiManager.createLabel("labelMouseStrength",    mouseStrength,    font, 0, 0, characterSize);
     auto& labelMouseRadius      = guiManager.createLabel("labelMouseRadius",      mouseRadius,      font, 0, 0, characterSize);
     auto& labelWrapEdge         = guiManager.createLabel("labelWrapEdge",         wrapEdge,         font, 0, 0, characterSize);
+    auto& labelMigrationRate    = guiManager.createLabel("labelMigrationRate",    migrationRate,    font, 0, 0, characterSize);
 
     auto& sliderCohesion         = guiManager.createSlider("sliderCohesion",         slider, 0, 0, 1.f, 200.f, simulation.getCohesion());
     auto& sliderSeparation       = guiManager.createSlider("sliderSeparation",       slider, 0, 0, 0.0f, 10.f, simulation.getSeparation());
@@ -136,75 +139,67 @@ void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulat
 
     sliderCohesion.callback(1, [&sliderCohesion, &labelCohesion, &simulation]{
         labelCohesion.setText(convert("Cohesion: ", sliderCohesion.getValue(), 0));
-        simulation.setCohesion(sliderCohesion.getValue());
+        simulation.push(Command(Command::SetCohesion, sliderCohesion.getValue()));
     });
 
     sliderSeparation.callback(1, [&sliderSeparation, &labelSeparation, &simulation] {
         labelSeparation.setText(convert("Separation: ", sliderSeparation.getValue(), 3));
-        simulation.setSeparation(sliderSeparation.getValue());
+        simulation.push(Command(Command::SetSeparation, sliderSeparation.getValue()));
     });
 
     sliderSeparationRadius.callback(1, [&sliderSeparationRadius, &labelSeparationRadius, &simulation]{
         labelSeparationRadius.setText(convert("Seperation radius: ", sliderSeparationRadius.getValue(), 0));
-        simulation.setSeperationRadius(static_cast<int>(sliderSeparationRadius.getValue()));
+        simulation.push(Command(Command::SetSeparationRadius, static_cast<int>(sliderSeparationRadius.getValue())));
     });
 
     sliderAlignment.callback(1, [&sliderAlignment, &labelAlignment, &simulation]{
         labelAlignment.setText(convert("Alignment: ", sliderAlignment.getValue(), 0));
-        simulation.setAlignment(sliderAlignment.getValue());
+        simulation.push(Command(Command::SetAlignment, sliderAlignment.getValue()));
     });
 
     sliderBaseVelocity.callback(1, [&sliderBaseVelocity, &labelBaseVelocity, &simulation]{
         labelBaseVelocity.setText(convert("Base velocity: ", sliderBaseVelocity.getValue(), 1));
-        simulation.setBaseVelocity(sliderBaseVelocity.getValue());
+        simulation.push(Command(Command::SetBaseVelocity, sliderBaseVelocity.getValue()));
     });
 
     sliderMaxVelocity.callback(1, [&sliderMaxVelocity, &labelMaxVelocity, &simulation]{
         labelMaxVelocity.setText(convert("Max velocity: ", sliderMaxVelocity.getValue(), 0));
-        simulation.setMaxVelocity(sliderMaxVelocity.getValue());
+        simulation.push(Command(Command::SetMaxVelocity, sliderMaxVelocity.getValue()));
     });
 
     sliderMouseStrength.callback(1, [&sliderMouseStrength, &labelMouseStrength, &simulation]{
         labelMouseStrength.setText(convert("Mouse strength: ", sliderMouseStrength.getValue(), 3));
-        simulation.setMouseStrength(sliderMouseStrength.getValue());
+        simulation.push(Command(Command::SetMouseStrength, sliderMouseStrength.getValue()));
     });
 
     sliderMouseRadius.callback(1, [&sliderMouseRadius, &labelMouseRadius, &simulation]{
         labelMouseRadius.setText(convert("Mouse radius: ", sliderMouseRadius.getValue(), 0));
-        simulation.setMouseRadius(static_cast<int>(sliderMouseRadius.getValue()));
+        simulation.push(Command(Command::SetMouseRadius, static_cast<int>(sliderMouseRadius.getValue())));
     });
 
-    buttonAdd.callback(1, [&application, &labelBoids, &simulation, &textBoids] {
-        int boids = sfx::convert<int>(textBoids.getText());
-
-        for(int i = 0; i < boids; i++)
-        {
-            float x = static_cast<float>(sfx::getRandom(0, application.getSize().x));
-            float y = static_cast<float>(sfx::getRandom(0, application.getSize().y));
-
-            simulation.addBoid(Boid(application.getTexture("Assets/Images/Boid.png"), {x, y}));
-        }
-
-        labelBoids.setText(convert("Boids: ", static_cast<float>(simulation.getBoids()), 0));
+    buttonAdd.callback(1, [&application, &simulation, &textBoids] {
+        sf::FloatRect area(0.f, 0.f, static_cast<float>(application.getSize().x), static_cast<float>(application.getSize().y));
+        simulation.push(Command(Command::AddBoid, sfx::convert<int>(textBoids.getText()), area, application.getTexture("Assets/Images/Boid.png")));
     });
 
-    buttonSub.callback(1, [&labelBoids, &simulation, &textBoids] {
-        int boids = sfx::convert<int>(textBoids.getText());
-
-        for(int i = 0; i < boids; i++)
-            simulation.popBoid();
-
-        labelBoids.setText(convert("Boids: ", static_cast<float>(simulation.getBoids()), 0));
+    buttonSub.callback(1, [&simulation, &textBoids] {
+        simulation.push(Command(Command::PopBoid, sfx::convert<int>(textBoids.getText())));
     });
 
-    checkboxFollowMouse.callback(0, [&simulation] { simulation.setFollowMouse(true); });
-    checkboxFollowMouse.callback(1, [&simulation] { simulation.setFollowMouse(false); });
-    checkboxAvoidMouse.callback(0, [&simulation] { simulation.setAvoidMouse(true); });
-    checkboxAvoidMouse.callback(1, [&simulation] { simulation.setAvoidMouse(false); });
-    checkboxDrawMouseRadius.callback(0, [&simulation] { simulation.setDrawMouseRadius(true); });
-    checkboxDrawMouseRadius.callback(1, [&simulation] { simulation.setDrawMouseRadius(false); });
-    checkboxWrapEdge.callback(0, [&simulation] { simulation.setWrapEdge(true); });
-    checkboxWrapEdge.callback(1, [&simulation] { simulation.setWrapEdge(false); });
+    // Commands are applied on the next tick, so the boid count is read back afterwards
+    refreshGui = [&labelBoids, &labelMigrationRate, &simulation] {
+        labelBoids.setText(convert("Boids: ", static_cast<float>(simulation.getBoids()), 0));
+        labelMigrationRate.setText(convert("Grid migration: ", simulation.getMigrationRate() * 100.f, 1) + "%");
+    };
+
+    checkboxFollowMouse.callback(0, [&simulation] { simulation.push(Command(Command::SetFollowMouse, true)); });
+    checkboxFollowMouse.callback(1, [&simulation] { simulation.push(Command(Command::SetFollowMouse, false)); });
+    checkboxAvoidMouse.callback(0, [&simulation] { simulation.push(Command(Command::SetAvoidMouse, true)); });
+    checkboxAvoidMouse.callback(1, [&simulation] { simulation.push(Command(Command::SetAvoidMouse, false)); });
+    checkboxDrawMouseRadius.callback(0, [&simulation] { simulation.push(Command(Command::SetDrawMouseRadius, true)); });
+    checkboxDrawMouseRadius.callback(1, [&simulation] { simulation.push(Command(Command::SetDrawMouseRadius, false)); });
+    checkboxWrapEdge.callback(0, [&simulation] { simulation.push(Command(Command::SetWrapEdge, true)); });
+    checkboxWrapEdge.callback(1, [&simulation] { simulation.push(Command(Command::SetWrapEdge, false)); });
 
     std::vector<sfx::GuiObject*> objects;
     objects.push_back(&labelCohesion);
@@ -250,6 +245,8 @@ void initGui(sfx::Application& application, sfx::GuiManager& guiManager, Simulat
 
     for(unsigned int i = 0; i < objects.size(); i++)
         objects[i]->setPosition(leftPadding1, i * 25.f + checkboxWrapEdge.getPosition().y + 40.f);
+
+    labelMigrationRate.setPosition(leftPadding1, sliderMouseRadius.getPosition().y + 40.f);
     
 
 }
@@ -11,6 +11,7 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFX/Utility/Utility.hpp>
 #include <SFML/Graphics/CircleShape.hpp>
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////////////////
 // Methods
@@ -20,7 +21,15 @@ static float getMagnitude(const sf::Vector2f& vector)
     return std::sqrt(vector.x * vector.x + vector.y * vector.y);
 }
 
+static float getGridCellSize(int separationRadius, float maxVelocity)
+{
+    // Cells at least as wide as a query plus one frame of drift at 60 fps, and
+    // never so small that a tiny radius explodes the bucket count
+    return std::max(separationRadius + maxVelocity / 60.f, 16.f);
+}
+
 Simulation::Simulation(unsigned int x, unsigned int y, unsigned int width, unsigned int height) :
+    m_grid (sf::FloatRect(static_cast<float>(x), static_cast<float>(y), static_cast<float>(width - x), static_cast<float>(height - y)), 1.f),
     m_x (x),
     m_y (y),
     m_width (width),
@@ -28,7 +37,10 @@ Simulation::Simulation(unsigned int x, unsigned int y, unsigned int width, unsig
     m_followMouse (false),
     m_avoidMouse (false),
     m_drawMouseRadius (false),
-    m_wrapEdge (false)
+    m_wrapEdge (false),
+    m_neighbourSlack (0.f),
+    m_tick (0),
+    m_recordCommands (false)
 {
     m_cohesion         = 100.f;
     m_separation       = 1.0f;
@@ -39,23 +51,122 @@ Simulation::Simulation(unsigned int x, unsigned int y, unsigned int width, unsig
     m_maxVelocity      = 400.f;
     m_mouseStrength    = 1.f;
     m_mouseRadius      = 100;
+
+    m_grid.setCellSize(getGridCellSize(m_separationRadius, m_maxVelocity));
 }
 
 void Simulation::addBoid(Boid& boid)
 {
     m_boids.push_back(boid);
+    m_grid.insert(m_boids.size() - 1, boid.getPosition());
 }
 
 void Simulation::popBoid()
 {
     if(m_boids.size() > 2)
+    {
+        m_grid.remove(m_boids.size() - 1);
         m_boids.pop_back();
+    }
+}
+
+bool Simulation::push(const Command& command)
+{
+    return m_commands.push(command);
+}
+
+void Simulation::applyCommands()
+{
+    Command command;
+    while(m_commands.pop(command))
+        m_batch.push_back(command);
+
+    // Grow the boid array at most once per batch, and geometrically, so
+    // repeated small spawns don't reallocate every tick
+    unsigned int spawns = 0;
+    for(const auto& c : m_batch)
+        if(c.type == Command::AddBoid && c.integer > 0)
+            spawns += c.integer;
+
+    if(m_boids.size() + spawns > m_boids.capacity())
+        m_boids.reserve(std::max(m_boids.size() + spawns, m_boids.capacity() * 2));
+
+    for(auto& c : m_batch)
+    {
+        c.tick = m_tick;
+
+        switch(c.type)
+        {
+        case Command::SetCohesion:         setCohesion(c.value);             break;
+        case Command::SetSeparation:       setSeparation(c.value);           break;
+        case Command::SetSeparationRadius: setSeperationRadius(c.integer);   break;
+        case Command::SetAlignment:        setAlignment(c.value);            break;
+        case Command::SetBaseVelocity:     setBaseVelocity(c.value);         break;
+        case Command::SetMaxVelocity:      setMaxVelocity(c.value);          break;
+        case Command::SetMouseStrength:    setMouseStrength(c.value);        break;
+        case Command::SetMouseRadius:      setMouseRadius(c.integer);        break;
+        case Command::SetMousePosition:    setMousePosition(c.position);     break;
+        case Command::SetFollowMouse:      setFollowMouse(c.flag);           break;
+        case Command::SetAvoidMouse:       setAvoidMouse(c.flag);            break;
+        case Command::SetDrawMouseRadius:  setDrawMouseRadius(c.flag);       break;
+        case Command::SetWrapEdge:         setWrapEdge(c.flag);              break;
+        case Command::SetSeed:
+            m_random.seed(static_cast<unsigned int>(c.integer));
+            break;
+        case Command::AddBoid:
+            if(c.texture)
+            {
+                std::uniform_real_distribution<float> unit(0.f, 1.f);
+                for(int i = 0; i < c.integer; i++)
+                {
+                    float x = c.area.left + c.area.width  * unit(m_random);
+                    float y = c.area.top  + c.area.height * unit(m_random);
+
+                    Boid boid(*c.texture, {x, y});
+                    addBoid(boid);
+                }
+            }
+            break;
+        case Command::PopBoid:
+            for(int i = 0; i < c.integer; i++)
+                popBoid();
+            break;
+        case Command::Tick:
+            break;
+        }
+
+        if(m_recordCommands)
+            m_commandLog.push_back(c);
+    }
+
+    m_batch.clear();
+}
+
+void Simulation::replay(const std::vector<Command>& commandLog)
+{
+    // Each Tick entry closes the batch recorded before it
+    for(const auto& c : commandLog)
+    {
+        if(c.type == Command::Tick)
+            update(c.value);
+        else
+            while(!push(c))
+                applyCommands();
+    }
 }
 
 void Simulation::update(float dt)
 {
-    for(auto& boid : m_boids)
+    applyCommands();
+
+    // Buckets reflect positions at the start of the tick. A neighbour can drift
+    // at most m_maxVelocity * dt from its bucket while the tick runs.
+    m_grid.update(m_boids);
+    m_neighbourSlack = m_maxVelocity * dt;
+
+    for(unsigned int i = 0; i < m_boids.size(); i++)
     {
+        Boid& boid = m_boids[i];
         sf::Vector2f velocity;
 
         velocity += applyCohesion(boid)    / m_cohesion;
@@ -63,7 +174,11 @@ void Simulation::update(float dt)
         velocity += applyAlignment(boid)   / m_alignment;
 
         if(m_wrapEdge)
+        {
+            // Wrapping teleports the boid, so its bucket can't wait for the next tick
             applyWrapEdge(boid);
+            m_grid.relocate(i, boid.getPosition());
+        }
         else
             velocity += applyScreenBound(boid) * m_screenBound;
 
@@ -72,10 +187,17 @@ void Simulation::update(float dt)
         if(m_avoidMouse)
             velocity -= applyMousePosition(boid) * m_mouseStrength;
 
-        boid.setVelocity((boid.getVelocity() + velocity) * m_baseVelocity);
-        applyVelocityLimit(boid);
-        boid.setPosition(boid.getPosition() + boid.getVelocity() * dt);
+        applyIntegration(boid, velocity, dt);
     }
+
+    if(m_recordCommands)
+    {
+        Command tick(Command::Tick, dt);
+        tick.tick = m_tick;
+        m_commandLog.push_back(tick);
+    }
+
+    m_tick++;
 }
     
 void Simulation::draw(sf::RenderTarget& target, sf::RenderStates states) const
@@ -110,9 +232,11 @@ sf::Vector2f Simulation::applyCohesion(Boid& boid) const
 sf::Vector2f Simulation::applySeparation(Boid& boid) const
 {
     sf::Vector2f v;
-    for(const auto& b : m_boids)
+    m_grid.forEachNear(boid.getPosition(), m_separationRadius + m_neighbourSlack, [&](unsigned int id) {
+        const auto& b = m_boids[id];
         if(&b != &boid && getMagnitude(b.getPosition() - boid.getPosition()) < m_separationRadius)
             v -= b.getPosition() - boid.getPosition();
+    });
 
     return v;
 }
@@ -150,6 +274,13 @@ void Simulation::applyVelocityLimit(Boid& boid) const
         boid.setVelocity(boid.getVelocity() / magnitude * m_maxVelocity);
 }
 
+void Simulation::applyIntegration(Boid& boid, const sf::Vector2f& velocity, float dt) const
+{
+    boid.setVelocity((boid.getVelocity() + velocity) * m_baseVelocity);
+    applyVelocityLimit(boid);
+    boid.setPosition(boid.getPosition() + boid.getVelocity() * dt);
+}
+
 void Simulation::applyWrapEdge(Boid& boid) const
 {
     if(boid.getPosition().x < m_x)
@@ -228,6 +359,16 @@ bool Simulation::getAvoidMouse() const
     return m_avoidMouse;
 }
 
+float Simulation::getMigrationRate() const
+{
+    return m_grid.getMigrationRate();
+}
+
+const std::vector<Command>& Simulation::getCommandLog() const
+{
+    return m_commandLog;
+}
+
 void Simulation::setCohesion(float cohesion)
 {
     m_cohesion = cohesion;
@@ -241,6 +382,7 @@ void Simulation::setSeparation(float separation)
 void Simulation::setSeperationRadius(int seperationRadius)
 {
     m_separationRadius = seperationRadius;
+    m_grid.setCellSize(getGridCellSize(m_separationRadius, m_maxVelocity));
 }
 
 void Simulation::setAlignment(float alignment)
@@ -256,6 +398,7 @@ void Simulation::setBaseVelocity(float baseVelocity)
 void Simulation::setMaxVelocity(float maxVelocity)
 {
     m_maxVelocity = maxVelocity;
+    m_grid.setCellSize(getGridCellSize(m_separationRadius, m_maxVelocity));
 }
 
 void Simulation::setMouseStrength(float mouseStrength)
@@ -291,4 +434,9 @@ void Simulation::setDrawMouseRadius(bool drawMouseRadius)
 void Simulation::setWrapEdge(bool wrapEdge)
 {
     m_wrapEdge = wrapEdge;
+}
+
+void Simulation::setRecordCommands(bool recordCommands)
+{
+    m_recordCommands = recordCommands;
 }
\ No newline at end of file
@@ -11,17 +11,27 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Window/Event.hpp>
+#include <random>
 #include <vector>
 #include "Boid.hpp"
+#include "SpatialGrid.hpp"
+#include "CommandQueue.hpp"
 
 class Simulation : public sf::Drawable
 {
+    // Times the private rule kernels in isolation
+    friend class KernelBenchmark;
+
 public:
     Simulation(unsigned int x, unsigned int y, unsigned int width, unsigned int height);
 
     void addBoid(Boid& boid);
     void popBoid();
 
+    bool push(const Command& command);
+    void applyCommands();
+    void replay(const std::vector<Command>& commandLog);
+
     void update(float dt);
     void draw(sf::RenderTarget& target, sf::RenderStates states) const;
 
@@ -36,6 +46,8 @@ public:
     int getMouseRadius() const;
     bool getFollowMouse() const;
     bool getAvoidMouse() const;
+    float getMigrationRate() const;
+    const std::vector<Command>& getCommandLog() const;
 
     void setCohesion(float cohesion);
     void setSeparation(float separation);
@@ -50,6 +62,7 @@ public:
     void setAvoidMouse(bool avoidMouse);
     void setDrawMouseRadius(bool drawMouseRadius);
     void setWrapEdge(bool wrapEdge);
+    void setRecordCommands(bool recordCommands);
 
 private:
 
@@ -61,10 +74,16 @@ private:
 
     void applyWrapEdge(Boid& boid) const;
     void applyVelocityLimit(Boid& boid) const;
+    void applyIntegration(Boid& boid, const sf::Vector2f& velocity, float dt) const;
 
 private:
 
-    std::vector<Boid> m_boids;
+    std::vector<Boid>    m_boids;
+    SpatialGrid          m_grid;
+    CommandQueue         m_commands;
+    std::mt19937         m_random;
+    std::vector<Command> m_batch;
+    std::vector<Command> m_commandLog;
 
     unsigned int m_x;
     unsigned int m_y;
@@ -85,6 +104,9 @@ private:
     bool         m_avoidMouse;
     bool         m_drawMouseRadius;
     bool         m_wrapEdge;
+    float        m_neighbourSlack;
+    unsigned int m_tick;
+    bool         m_recordCommands;
 };
 
 #endif
\ No newline at end of file
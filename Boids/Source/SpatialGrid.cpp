@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: SpatialGrid.cpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////
+// Methods
+////////////////////////////////////////////////////////////////////////////////
+SpatialGrid::SpatialGrid(const sf::FloatRect& bounds, float cellSize) :
+    m_bounds (bounds),
+    m_cellSize (std::max(cellSize, 1.f)),
+    m_columns (1),
+    m_rows (1),
+    m_migrationRate (0.f),
+    m_rebuildThreshold (0.25f),
+    m_compactInterval (300),
+    m_ticksSinceRebuild (0),
+    m_dirty (true),
+    m_rebuilt (false)
+{
+    // Buckets are allocated by the first rebuild, once the cell size is final
+}
+
+void SpatialGrid::insert(unsigned int id, const sf::Vector2f& position)
+{
+    if(id >= m_boidCells.size())
+    {
+        m_boidCells.resize(id + 1);
+        m_boidSlots.resize(id + 1);
+    }
+
+    // Buckets are refilled by the next rebuild
+    if(m_dirty)
+        return;
+
+    unsigned int cell = getCell(position);
+    m_boidCells[id] = cell;
+    m_boidSlots[id] = m_cells[cell].size();
+    m_cells[cell].push_back(id);
+}
+
+void SpatialGrid::remove(unsigned int id)
+{
+    if(m_dirty)
+    {
+        m_boidCells.pop_back();
+        m_boidSlots.pop_back();
+        return;
+    }
+
+    // Swap-remove the entry from its bucket
+    auto& bucket = m_cells[m_boidCells[id]];
+    bucket[m_boidSlots[id]] = bucket.back();
+    m_boidSlots[bucket.back()] = m_boidSlots[id];
+    bucket.pop_back();
+
+    // Mirror a swap-remove in the boid array: the last boid takes over the id
+    unsigned int last = m_boidCells.size() - 1;
+    if(id != last)
+    {
+        m_cells[m_boidCells[last]][m_boidSlots[last]] = id;
+        m_boidCells[id] = m_boidCells[last];
+        m_boidSlots[id] = m_boidSlots[last];
+    }
+
+    m_boidCells.pop_back();
+    m_boidSlots.pop_back();
+}
+
+bool SpatialGrid::relocate(unsigned int id, const sf::Vector2f& position)
+{
+    unsigned int cell = getCell(position);
+    if(cell == m_boidCells[id])
+        return false;
+
+    auto& bucket = m_cells[m_boidCells[id]];
+    bucket[m_boidSlots[id]] = bucket.back();
+    m_boidSlots[bucket.back()] = m_boidSlots[id];
+    bucket.pop_back();
+
+    m_boidCells[id] = cell;
+    m_boidSlots[id] = m_cells[cell].size();
+    m_cells[cell].push_back(id);
+
+    return true;
+}
+
+void SpatialGrid::update(std::vector<Boid>& boids)
+{
+    if(m_dirty || boids.size() != m_boidCells.size() || m_ticksSinceRebuild >= m_compactInterval)
+    {
+        compact(boids);
+        return;
+    }
+
+    // Last tick's migration rate predicts this one; past the threshold moving
+    // boids one by one costs more than refilling every bucket
+    if(m_migrationRate > m_rebuildThreshold)
+    {
+        rebuild(boids);
+        return;
+    }
+
+    unsigned int migrated = 0;
+    for(unsigned int i = 0; i < boids.size(); i++)
+        if(relocate(i, boids[i].getPosition()))
+            migrated++;
+
+    m_migrationRate = boids.empty() ? 0.f : static_cast<float>(migrated) / boids.size();
+    m_ticksSinceRebuild++;
+    m_rebuilt = false;
+}
+
+void SpatialGrid::rebuild(const std::vector<Boid>& boids)
+{
+    bool comparable = !m_dirty && boids.size() == m_boidCells.size();
+    if(m_dirty)
+        resize();
+
+    for(auto& bucket : m_cells)
+        bucket.clear();
+
+    unsigned int migrated = 0;
+    m_boidCells.resize(boids.size());
+    m_boidSlots.resize(boids.size());
+
+    for(unsigned int i = 0; i < boids.size(); i++)
+    {
+        unsigned int cell = getCell(boids[i].getPosition());
+        if(comparable && cell != m_boidCells[i])
+            migrated++;
+
+        m_boidCells[i] = cell;
+        m_boidSlots[i] = m_cells[cell].size();
+        m_cells[cell].push_back(i);
+    }
+
+    m_migrationRate = boids.empty() ? 0.f : static_cast<float>(migrated) / boids.size();
+    m_ticksSinceRebuild = 0;
+    m_rebuilt = true;
+}
+
+void SpatialGrid::compact(std::vector<Boid>& boids)
+{
+    rebuild(boids);
+
+    // Reorder the boids bucket by bucket so boids sharing a cell are adjacent
+    // in memory, then renumber the buckets to match. The scratch array is kept
+    // between compactions and swapped with the boids, so neither loses its
+    // capacity and steady state doesn't allocate.
+    m_scratch.clear();
+    m_scratch.reserve(boids.capacity());
+
+    unsigned int id = 0;
+    for(unsigned int cell = 0; cell < m_cells.size(); cell++)
+    {
+        auto& bucket = m_cells[cell];
+        for(unsigned int slot = 0; slot < bucket.size(); slot++)
+        {
+            m_scratch.push_back(boids[bucket[slot]]);
+            bucket[slot]    = id;
+            m_boidCells[id] = cell;
+            m_boidSlots[id] = slot;
+            id++;
+        }
+    }
+
+    boids.swap(m_scratch);
+    m_scratch.clear();
+}
+
+float SpatialGrid::getMigrationRate() const
+{
+    return m_migrationRate;
+}
+
+bool SpatialGrid::getRebuilt() const
+{
+    return m_rebuilt;
+}
+
+float SpatialGrid::getRebuildThreshold() const
+{
+    return m_rebuildThreshold;
+}
+
+unsigned int SpatialGrid::getCompactInterval() const
+{
+    return m_compactInterval;
+}
+
+void SpatialGrid::setCellSize(float cellSize)
+{
+    cellSize = std::max(cellSize, 1.f);
+    if(cellSize != m_cellSize)
+    {
+        m_cellSize = cellSize;
+        m_dirty = true;
+    }
+}
+
+void SpatialGrid::setRebuildThreshold(float rebuildThreshold)
+{
+    m_rebuildThreshold = rebuildThreshold;
+}
+
+void SpatialGrid::setCompactInterval(unsigned int compactInterval)
+{
+    m_compactInterval = compactInterval;
+}
+
+int SpatialGrid::getColumn(float x) const
+{
+    float column = std::floor((x - m_bounds.left) / m_cellSize);
+    return static_cast<int>(std::min(std::max(column, 0.f), m_columns - 1.f));
+}
+
+int SpatialGrid::getRow(float y) const
+{
+    float row = std::floor((y - m_bounds.top) / m_cellSize);
+    return static_cast<int>(std::min(std::max(row, 0.f), m_rows - 1.f));
+}
+
+unsigned int SpatialGrid::getCell(const sf::Vector2f& position) const
+{
+    return getRow(position.y) * m_columns + getColumn(position.x);
+}
+
+void SpatialGrid::resize()
+{
+    m_columns = std::max(static_cast<int>(std::ceil(m_bounds.width  / m_cellSize)), 1);
+    m_rows    = std::max(static_cast<int>(std::ceil(m_bounds.height / m_cellSize)), 1);
+
+    m_cells.clear();
+    m_cells.resize(m_columns * m_rows);
+    m_dirty = false;
+}
\ No newline at end of file
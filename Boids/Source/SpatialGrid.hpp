@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename: SpatialGrid.hpp
+// Author:   Tobias Savinainen
+// Year:     2014
+////////////////////////////////////////////////////////////////////////////////
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Header files
+////////////////////////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include "Boid.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Uniform grid of buckets holding boid indices. The grid is kept alive between
+// ticks and only boids that crossed a cell boundary are moved between buckets
+// (swap-remove from the old cell, append to the new one). When too many boids
+// migrate the buckets are rebuilt from scratch instead. Every m_compactInterval
+// ticks the grid is compacted: the boid array itself is sorted by cell and the
+// buckets are rebuilt, so each bucket again refers to a contiguous run of boids.
+////////////////////////////////////////////////////////////////////////////////
+class SpatialGrid
+{
+public:
+
+    SpatialGrid(const sf::FloatRect& bounds, float cellSize);
+
+    void insert(unsigned int id, const sf::Vector2f& position);
+    void remove(unsigned int id);
+    bool relocate(unsigned int id, const sf::Vector2f& position);
+
+    void update(std::vector<Boid>& boids);
+    void rebuild(const std::vector<Boid>& boids);
+    void compact(std::vector<Boid>& boids);
+
+    template <typename Function>
+    void forEachNear(const sf::Vector2f& position, float radius, Function function) const;
+
+    float getMigrationRate() const;
+    bool getRebuilt() const;
+    float getRebuildThreshold() const;
+    unsigned int getCompactInterval() const;
+
+    void setCellSize(float cellSize);
+    void setRebuildThreshold(float rebuildThreshold);
+    void setCompactInterval(unsigned int compactInterval);
+
+private:
+
+    int getColumn(float x) const;
+    int getRow(float y) const;
+    unsigned int getCell(const sf::Vector2f& position) const;
+
+    void resize();
+
+private:
+
+    std::vector<std::vector<unsigned int>> m_cells;
+    std::vector<unsigned int>              m_boidCells;
+    std::vector<unsigned int>              m_boidSlots;
+    std::vector<Boid>                      m_scratch;
+
+    sf::FloatRect m_bounds;
+    float         m_cellSize;
+    int           m_columns;
+    int           m_rows;
+
+    float         m_migrationRate;
+    float         m_rebuildThreshold;
+    unsigned int  m_compactInterval;
+    unsigned int  m_ticksSinceRebuild;
+    bool          m_dirty;
+    bool          m_rebuilt;
+};
+
+template <typename Function>
+void SpatialGrid::forEachNear(const sf::Vector2f& position, float radius, Function function) const
+{
+    int left   = getColumn(position.x - radius);
+    int right  = getColumn(position.x + radius);
+    int top    = getRow(position.y - radius);
+    int bottom = getRow(position.y + radius);
+
+    for(int row = top; row <= bottom; row++)
+        for(int column = left; column <= right; column++)
+            for(auto id : m_cells[row * m_columns + column])
+                function(id);
+}
+
+#endif
\ No newline at end of file